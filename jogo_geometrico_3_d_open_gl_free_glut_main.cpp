@@ -4,6 +4,7 @@
 */
 
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
 #include <string>
@@ -29,9 +30,9 @@ static float dist2(const Vec3& a, const Vec3& b) { float dx=a.x-b.x, dy=a.y-b.y,
 //============================= Jogo =================================//
 struct Obj {
     Vec3 pos;         // posição
-    float r=0.5f;     // raio p/ colisão (define o TAMANHO do cubo vermelho / pellet)
+    float r=0.5f;     // raio p/ colisão (define o TAMANHO do cubo vermelho)
     float rot=0.f;    // rotação visual
-    int kind=0;       // 0: pellet (pirâmide) | 1: inimigo (cubo vermelho)
+    int kind=1;       // 1: inimigo (cubo vermelho) — pellets ficam na grade de ocupação
     Vec3 vel;         // para inimigos móveis
 };
 
@@ -43,17 +44,35 @@ static const float WALL_H     = 3.0f;
 static const float GATE_W     = 8.0f;   // largura do portão no lado +Z (norte)
 
 // Jogador
-static Vec3 player{0.f, 0.6f, 0.f};
+static Vec3 player{0.f, 0.6f, 0.f}; // centro de massa das células (câmera / mira)
 static float playerR = 0.6f;   // raio colisor base do jogador
 static float playerYaw = 0.f;  // orientação visual
 static float baseSpeed = 9.0f; // m/s base
-static float mass = 1.0f;      // cresce ao comer
+static float mass = 1.0f;      // massa total (soma das células)
 static float dashCd = 0.f;     // recarga do dash
-static Vec3 playerCurrentVel = {0.f, 0.f, 0.f}; // Velocidade atual do jogador
 static float decelerationFactor = 0.95f; // Fator de desaceleração (0.0 a 1.0, mais próximo de 1.0 = mais lento para parar)
 static float maxPlayerSpeed = 9.0f; // Velocidade máxima do jogador
 static float accelerationFactor = 0.1f; // Fator de aceleração (0.0 a 1.0, controla quão rápido atinge a velocidade máxima)
 
+// Células do jogador (split/merge estilo Agar.io) — array contíguo processado em lote
+struct Cell {
+    Vec3 pos;
+    Vec3 vel;           // velocidade de controle (aceleração suavizada)
+    Vec3 boost;         // impulso do split, decai com o tempo
+    float mass=1.f;
+    float rad=0.f;      // playerR * cbrt(mass) — só recalculado em setCellMass()
+    float mergeCd=0.f;  // recarga até poder recombinar
+};
+static const int   MAX_CELLS      = 16;
+static const float SPLIT_MIN_MASS = 2.0f;  // massa mínima para dividir
+static const float SPLIT_SPEED    = 18.0f; // impulso inicial da célula ejetada
+static const float SPLIT_DECAY    = 4.0f;  // decaimento do impulso (1/s)
+static const float MERGE_TIME     = 8.0f;  // segundos até recombinar
+static const float MERGE_PULL     = 1.5f;  // atração ao centro quando já pode recombinar
+static const float CELL_STIFF     = 10.0f; // rigidez da separação entre células (1/s)
+static Cell cells[MAX_CELLS];
+static int cellCount = 1;
+
 
 // Sistema de jogo
 static int score = 0;
@@ -70,9 +89,27 @@ static int menuIndex = 0;
 static const int MENU_ITEMS = 3;
 static const char* menuLabels[MENU_ITEMS] = {"Iniciar", "Controles", "Sair"};
 
-static std::vector<Obj> pellets;    // pirâmides pequenas (comida)
 static std::vector<Obj> enemies;    // cubos vermelhos (tamanhos variados)
 
+// Pellets (pirâmides pequenas / comida) — grade de ocupação estática.
+// Pellets não se movem: cada célula XZ da grade é 1 bit (ocupada ou livre).
+// Comer = varrer só as células sob o raio do jogador; respawn = sortear 1 célula livre.
+// A célula tem o tamanho da pegada do pellet, então a grade escala com o mundo:
+// WORLD_HALF = 25 → 50 x 50 células; WORLD_HALF = 512 → 1024 x 1024 ≈ 1M células.
+static const float PELLET_CELL  = 1.0f;                        // tamanho da célula (≥ 2*PELLET_R)
+static const int   PELLET_GRID  = (int)(2.f*WORLD_HALF / PELLET_CELL); // células por lado
+static const int   PELLET_WORDS = (PELLET_GRID + 63) / 64;     // palavras de 64 bits por linha
+static const float PELLET_R     = 0.45f;                       // raio de colisão do pellet
+static const float PELLET_Y     = 0.5f;                        // altura fixa dos pellets
+static const int   PELLET_COUNT = 16;                          // pellets vivos no mapa
+static std::vector<uint64_t> pelletBits;     // PELLET_GRID linhas x PELLET_WORDS palavras
+static std::vector<int> pelletFree;          // células livres (cz*PELLET_GRID + cx)
+static float worldTime = 0.f;                // tempo de jogo (giro dos pellets)
+
+// Retângulo XZ visível da câmera (atualizado a cada quadro em display())
+static float viewX0 = -WORLD_HALF, viewX1 = WORLD_HALF;
+static float viewZ0 = -WORLD_HALF, viewZ1 = WORLD_HALF;
+
 struct Particle {
     Vec3 pos;
     Vec3 vel;
@@ -110,43 +147,44 @@ static void setLight()
 
 static void drawCube(float s=1.f) { glutSolidCube(s); }
 
-static void drawPyramid(float base=0.7f, float h=0.7f)
+// Emite uma pirâmide já posicionada e girada em Y, para uso dentro de glBegin(GL_TRIANGLES):
+// todos os pellets visíveis saem num único lote.
+static void emitPyramid(const Vec3& p, float yawDeg, float base=0.7f, float h=0.7f)
 {
     float b = base * 0.5f;
-    glBegin(GL_TRIANGLES);
-      glNormal3f(0.f, h, b);
-      glVertex3f( 0.f, h, 0.f);
-      glVertex3f(-b, 0.f, b);
-      glVertex3f( b, 0.f, b);
-      glNormal3f(b, h, 0.f);
-      glVertex3f( 0.f, h, 0.f);
-      glVertex3f( b, 0.f,  b);
-      glVertex3f( b, 0.f, -b);
-      glNormal3f(0.f, h, -b);
-      glVertex3f( 0.f, h, 0.f);
-      glVertex3f( b, 0.f, -b);
-      glVertex3f(-b, 0.f, -b);
-      glNormal3f(-b, h, 0.f);
-      glVertex3f( 0.f, h, 0.f);
-      glVertex3f(-b, 0.f, -b);
-      glVertex3f(-b, 0.f,  b);
-    glEnd();
-    glBegin(GL_QUADS);
-      glNormal3f(0.f,-1.f,0.f);
-      glVertex3f(-b,0.f, b);
-      glVertex3f( b,0.f, b);
-      glVertex3f( b,0.f,-b);
-      glVertex3f(-b,0.f,-b);
-    glEnd();
+    float a = yawDeg * 3.1415926f / 180.f, cs = std::cos(a), sn = std::sin(a);
+    // cantos da base e normais das faces laterais (antes do giro)
+    const float bx[4] = {-b,  b,  b, -b};
+    const float bz[4] = { b,  b, -b, -b};
+    const float nx[4] = {0.f, b, 0.f, -b};
+    const float nz[4] = { b, 0.f, -b, 0.f};
+    float vx[4], vz[4];
+    for (int i=0;i<4;i++) { vx[i] = p.x + bx[i]*cs + bz[i]*sn; vz[i] = p.z - bx[i]*sn + bz[i]*cs; }
+    for (int i=0;i<4;i++) {
+        int j = (i+1) & 3;
+        glNormal3f(nx[i]*cs + nz[i]*sn, h, -nx[i]*sn + nz[i]*cs);
+        glVertex3f(p.x, p.y + h, p.z);
+        glVertex3f(vx[i], p.y, vz[i]);
+        glVertex3f(vx[j], p.y, vz[j]);
+    }
+    // base (dois triângulos)
+    glNormal3f(0.f,-1.f,0.f);
+    glVertex3f(vx[0], p.y, vz[0]); glVertex3f(vx[1], p.y, vz[1]); glVertex3f(vx[2], p.y, vz[2]);
+    glVertex3f(vx[0], p.y, vz[0]); glVertex3f(vx[2], p.y, vz[2]); glVertex3f(vx[3], p.y, vz[3]);
 }
 
 //======================= CENÁRIO ====================================//
 static void drawCheckerFloor(float half, float tile=1.0f)
 {
+    // só os ladrilhos dentro do retângulo visível da câmera
+    int n = (int)std::ceil(2*half/tile);
+    int ix0 = std::max(0, (int)std::floor((viewX0+half)/tile)), ix1 = std::min(n, (int)std::ceil((viewX1+half)/tile));
+    int iz0 = std::max(0, (int)std::floor((viewZ0+half)/tile)), iz1 = std::min(n, (int)std::ceil((viewZ1+half)/tile));
     glBegin(GL_QUADS);
-    for (float x=-half; x<half; x+=tile) {
-        for (float z=-half; z<half; z+=tile) {
-            bool dark = ( ((int)std::floor((x+half)/tile) + (int)std::floor((z+half)/tile)) % 2 )==0;
+    for (int ix=ix0; ix<ix1; ix++) {
+        for (int iz=iz0; iz<iz1; iz++) {
+            float x = -half + ix*tile, z = -half + iz*tile;
+            bool dark = ((ix + iz) % 2)==0;
             glColor3f(dark?0.10f:0.20f, dark?0.10f:0.20f, dark?0.14f:0.26f);
             glNormal3f(0,1,0);
             glVertex3f(x,   GROUND_Y, z);
@@ -220,14 +258,17 @@ static void drawArena()
 //======================= Entidades ==================================
 static void drawPlayer()
 {
-    glPushMatrix();
-    glTranslatef(player.x, player.y, player.z);
-    glRotatef(playerYaw, 0,1,0);
-    float scale = std::cbrt(mass);
-    glScalef(scale, scale, scale);
     glColor3f(0.2f, 0.75f, 1.0f);
-    drawCube(1.0f);
-    glPopMatrix();
+    for (int i=0; i<cellCount; i++) {
+        const Cell& c = cells[i];
+        glPushMatrix();
+        glTranslatef(c.pos.x, c.pos.y, c.pos.z);
+        glRotatef(playerYaw, 0,1,0);
+        float scale = c.rad / playerR; // = cbrt(mass) da célula, já em cache
+        glScalef(scale, scale, scale);
+        drawCube(1.0f);
+        glPopMatrix();
+    }
 }
 
 static void drawEnemy(const Obj& o)
@@ -242,14 +283,72 @@ static void drawEnemy(const Obj& o)
     glPopMatrix();
 }
 
-static void drawPellet(const Obj& o)
+// Índice do bit menos significativo ligado (w != 0)
+static int lowestBit(uint64_t w)
 {
-    glPushMatrix();
-    glTranslatef(o.pos.x, o.pos.y, o.pos.z);
-    glRotatef(o.rot, 0,1,0);
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(w);
+#else
+    int i = 0; while (!(w & 1u)) { w >>= 1; ++i; } return i;
+#endif
+}
+
+static Vec3 pelletCellPos(int cx, int cz)
+{ return { -WORLD_HALF + (cx + 0.5f)*PELLET_CELL, PELLET_Y, -WORLD_HALF + (cz + 0.5f)*PELLET_CELL }; }
+
+static int pelletCellOf(float v)
+{ return (int)clampf(std::floor((v + WORLD_HALF) / PELLET_CELL), 0.f, (float)(PELLET_GRID - 1)); }
+
+// Máscara dos bits [x0, x1] que caem na palavra w da linha
+static uint64_t pelletRowMask(int w, int x0, int x1)
+{
+    uint64_t mask = ~0ull;
+    if (w == (x0 >> 6)) mask &= ~0ull << (x0 & 63);
+    if (w == (x1 >> 6)) mask &= ~0ull >> (63 - (x1 & 63));
+    return mask;
+}
+
+// Calcula o retângulo XZ visível: cantos do frustum projetados no chão (y = GROUND_Y)
+static void computeViewRect(const Vec3& eye, const Vec3& at, float fovY, float aspect, float zFar)
+{
+    float fx = at.x-eye.x, fy = at.y-eye.y, fz = at.z-eye.z;
+    float fl = std::sqrt(fx*fx + fy*fy + fz*fz); fx/=fl; fy/=fl; fz/=fl;
+    float rx = -fz, rz = fx; // f x (0,1,0)
+    float rl = std::sqrt(rx*rx + rz*rz) + 1e-6f; rx/=rl; rz/=rl;
+    float ux = -rz*fy, uy = rz*fx - rx*fz, uz = rx*fy; // r x f
+    float tv = std::tan(fovY*0.5f*3.1415926f/180.f), th = tv*aspect;
+    float x0 = eye.x, x1 = eye.x, z0 = eye.z, z1 = eye.z;
+    for (int sx=-1; sx<=1; sx+=2) for (int sy=-1; sy<=1; sy+=2) {
+        float dx = fx + rx*sx*th + ux*sy*tv, dy = fy + uy*sy*tv, dz = fz + rz*sx*th + uz*sy*tv;
+        float dl = std::sqrt(dx*dx + dy*dy + dz*dz);
+        float t = zFar / dl; // raio que não atinge o chão: vai até o plano distante
+        if (dy < 0.f) t = std::min(t, (GROUND_Y - eye.y) / dy);
+        float px = eye.x + dx*t, pz = eye.z + dz*t;
+        x0 = std::min(x0, px); x1 = std::max(x1, px); z0 = std::min(z0, pz); z1 = std::max(z1, pz);
+    }
+    const float margin = 2.0f; // altura dos objetos acima do chão
+    viewX0 = x0 - margin; viewX1 = x1 + margin; viewZ0 = z0 - margin; viewZ1 = z1 + margin;
+}
+
+static void drawPellets()
+{
+    if (viewX1 < -WORLD_HALF || viewX0 > WORLD_HALF || viewZ1 < -WORLD_HALF || viewZ0 > WORLD_HALF) return;
+    int x0 = pelletCellOf(viewX0), x1 = pelletCellOf(viewX1);
+    int z0 = pelletCellOf(viewZ0), z1 = pelletCellOf(viewZ1);
     glColor3f(1.f, 0.9f, 0.2f);
-    drawPyramid(0.6f, 0.6f);
-    glPopMatrix();
+    glBegin(GL_TRIANGLES);
+    for (int cz=z0; cz<=z1; cz++) {
+        const uint64_t* row = &pelletBits[(size_t)cz*PELLET_WORDS];
+        for (int w = x0 >> 6; w <= (x1 >> 6); w++) {
+            for (uint64_t bits = row[w] & pelletRowMask(w, x0, x1); bits; bits &= bits - 1) {
+                int cx = w*64 + lowestBit(bits);
+                // giro derivado do tempo global + fase fixa por célula (sem estado por pellet)
+                uint32_t phase = (uint32_t)(cz*PELLET_GRID + cx) * 2654435761u;
+                emitPyramid(pelletCellPos(cx, cz), std::fmod(worldTime*60.f + (float)(phase % 360u), 360.f), 0.6f, 0.6f);
+            }
+        }
+    }
+    glEnd();
 }
 
 static void drawParticles()
@@ -337,7 +436,8 @@ static void drawHUD(int w, int h)
         drawBitmapText("Mouse             -> mover em rumo ao cursor", cx - 240, cy + 60);
         drawBitmapText("M                 -> alterna mouse / WASD", cx - 240, cy + 30);
         drawBitmapText("Espaço            -> dash curto à frente", cx - 240, cy + 0);
-        drawBitmapText("P                 -> pausar / R -> reiniciar / ESC -> sair", cx - 240, cy - 30);
+        drawBitmapText("E                 -> dividir (split) as células", cx - 240, cy - 30);
+        drawBitmapText("P                 -> pausar / R -> reiniciar / ESC -> sair", cx - 240, cy - 60);
         drawBitmapText("Pressione ou ESC para voltar ao menu", cx - 200, cy - 100);
 
         glMatrixMode(GL_MODELVIEW); glPopMatrix();
@@ -353,6 +453,7 @@ static void drawHUD(int w, int h)
                    "  Lives: "+std::to_string(lives)+
                    "  Level: "+std::to_string(level)+
                    "  Mass: "+std::to_string((int)mass)+
+                   "  Cells: "+std::to_string(cellCount)+
                    (mouseFollow?"  Mode: Mouse":"  Mode: WASD"), 10, h-24);
 
     if (!started && !gameOver) {
@@ -381,21 +482,67 @@ static Obj makeEnemy()
     return e;
 }
 
+// Sorteia uma célula livre (lista de livres: O(1) e uniforme) e liga o bit dela
+static void spawnPellet()
+{
+    if (pelletFree.empty()) return; // grade cheia
+    size_t k = (((size_t)std::rand() << 15) ^ (size_t)std::rand()) % pelletFree.size();
+    int idx = pelletFree[k];
+    pelletFree[k] = pelletFree.back();
+    pelletFree.pop_back();
+    int cx = idx % PELLET_GRID, cz = idx / PELLET_GRID;
+    pelletBits[(size_t)cz*PELLET_WORDS + (cx >> 6)] |= 1ull << (cx & 63);
+}
+
+// Apaga os pellets tocados por uma esfera em 'c' de raio 'rad' e devolve quantos foram
+// comidos ('at' = posição do primeiro, para as partículas).
+// Custo proporcional às células sob o raio, não ao número de pellets no mapa.
+static int eatPelletsAround(const Vec3& c, float rad, Vec3& at)
+{
+    float reach = rad + PELLET_R;
+    float dy = c.y - PELLET_Y;
+    float r2 = reach*reach - dy*dy;
+    if (r2 < 0.f) return 0;
+    int n = 0;
+    int x0 = pelletCellOf(c.x - reach), x1 = pelletCellOf(c.x + reach);
+    int z0 = pelletCellOf(c.z - reach), z1 = pelletCellOf(c.z + reach);
+    for (int cz=z0; cz<=z1; cz++) {
+        uint64_t* row = &pelletBits[(size_t)cz*PELLET_WORDS];
+        for (int w = x0 >> 6; w <= (x1 >> 6); w++) {
+            for (uint64_t bits = row[w] & pelletRowMask(w, x0, x1); bits; bits &= bits - 1) {
+                int b = lowestBit(bits);
+                Vec3 p = pelletCellPos(w*64 + b, cz);
+                float dx = c.x - p.x, dz = c.z - p.z;
+                if (dx*dx + dz*dz > r2) continue;
+                row[w] &= ~(1ull << b);
+                int idx = cz*PELLET_GRID + w*64 + b;
+                pelletFree.push_back(idx);
+                if (n++ == 0) at = p;
+            }
+        }
+    }
+    return n;
+}
+
 static void spawnWorld()
 {
-    pellets.clear(); enemies.clear();
+    enemies.clear();
     // pellets
-    for (int i=0;i<16;i++) {
-        Obj o; o.kind=0; o.r=0.45f; o.pos={frand(-WORLD_HALF, WORLD_HALF), 0.5f, frand(-WORLD_HALF, WORLD_HALF)}; o.rot=frand(0,360); pellets.push_back(o);
-    }
+    pelletBits.assign((size_t)PELLET_GRID*PELLET_WORDS, 0ull);
+    pelletFree.resize((size_t)PELLET_GRID*PELLET_GRID);
+    for (int i=0;i<(int)pelletFree.size();i++) pelletFree[i] = i;
+    for (int i=0;i<PELLET_COUNT;i++) spawnPellet();
     // inimigos
     for (int i=0;i<12;i++) enemies.push_back(makeEnemy());
 }
 
+static void setCellMass(Cell& c, float m) { c.mass = m; c.rad = playerR * std::cbrt(m); }
+
 static void resetGame()
 {
-    score=0; lives=1; level=1; paused=false; gameOver=false; started=false;
-    player={0.f,0.6f,0.f}; playerYaw=0.f; dashCd=0.f; playerCurrentVel={0.f,0.f,0.f}; maxPlayerSpeed=9.0f; mass=1.f;
+    score=0; lives=1; level=1; paused=false; gameOver=false; started=false; worldTime=0.f;
+    player={0.f,0.6f,0.f}; playerYaw=0.f; dashCd=0.f; maxPlayerSpeed=9.0f; mass=1.f;
+    cells[0] = Cell{}; cells[0].pos = player; setCellMass(cells[0], 1.f); cellCount = 1;
     // abrir menu ao resetar
     menuActive = true;
     showControlsMenu = false;
@@ -416,6 +563,73 @@ static void spawnParticles(const Vec3& pos, int count) {
     }
 }
 
+// Massa total e centro de massa (câmera, HUD e velocidade do dash)
+static void refreshPlayerTotals()
+{
+    float m = 0.f; Vec3 p{0.f, 0.f, 0.f};
+    for (int i=0; i<cellCount; i++) {
+        const Cell& c = cells[i];
+        m += c.mass; p.x += c.pos.x*c.mass; p.z += c.pos.z*c.mass;
+    }
+    mass = m; player = { p.x/m, 0.6f, p.z/m };
+}
+
+// Divide cada célula grande o bastante, ejetando a metade na direção (dx, dz)
+static void splitCells(float dx, float dz)
+{
+    int n = cellCount;
+    for (int i=0; i<n && cellCount<MAX_CELLS; i++) {
+        Cell& c = cells[i];
+        if (c.mass < SPLIT_MIN_MASS) continue;
+        setCellMass(c, c.mass*0.5f);
+        c.mergeCd = MERGE_TIME;
+        Cell& s = cells[cellCount++];
+        s = c;
+        s.pos.x += dx*c.rad; s.pos.z += dz*c.rad;
+        s.boost = { dx*SPLIT_SPEED, 0.f, dz*SPLIT_SPEED };
+        respawnInside(s.pos);
+    }
+}
+
+// Separação suave entre células em recarga; recombina as que já podem e se sobrepõem
+static void resolveCells(float dt)
+{
+    float k = std::min(1.f, CELL_STIFF*dt);
+    for (int i=0; i<cellCount; i++) {
+        for (int j=i+1; j<cellCount; j++) {
+            Cell& a = cells[i]; Cell& b = cells[j];
+            float dx = b.pos.x - a.pos.x, dz = b.pos.z - a.pos.z;
+            float rs = a.rad + b.rad, d2 = dx*dx + dz*dz;
+            if (d2 >= rs*rs) continue;
+            float d = std::sqrt(d2) + 1e-5f;
+            if (a.mergeCd <= 0.f && b.mergeCd <= 0.f) {
+                if (d < std::max(a.rad, b.rad)) {
+                    // funde b em a (centro e velocidade ponderados pela massa)
+                    float m = a.mass + b.mass, wa = a.mass/m, wb = b.mass/m;
+                    a.pos.x = a.pos.x*wa + b.pos.x*wb; a.pos.z = a.pos.z*wa + b.pos.z*wb;
+                    a.vel.x = a.vel.x*wa + b.vel.x*wb; a.vel.z = a.vel.z*wa + b.vel.z*wb;
+                    setCellMass(a, m);
+                    b = cells[--cellCount];
+                    j--;
+                }
+                continue; // prontas para fundir: podem se sobrepor
+            }
+            // empurra proporcional à sobreposição; a célula mais leve cede mais
+            float push = (rs - d) * k;
+            float m = a.mass + b.mass;
+            float nx = dx/d, nz = dz/d;
+            if (d2 < 1e-8f) {
+                // centros coincidentes (ex.: split contra a parede): eixo fixo pelo índice
+                float ang = (float)j * 2.3999632f; // ângulo áureo
+                nx = std::cos(ang); nz = std::sin(ang);
+            }
+            a.pos.x -= nx*push*(b.mass/m); a.pos.z -= nz*push*(b.mass/m);
+            b.pos.x += nx*push*(a.mass/m); b.pos.z += nz*push*(a.mass/m);
+        }
+    }
+    for (int i=0; i<cellCount; i++) respawnInside(cells[i].pos);
+}
+
 static void nextLevel()
 {
     level++;
@@ -448,11 +662,11 @@ static void updateGame(float dt)
     if (inputDir.x!=0.f || inputDir.z!=0.f)
         playerYaw = std::atan2(inputDir.x, -inputDir.z) * 180.f / 3.1415926f;
 
-    // velocidade diminui com massa (agar.io feel)
-    float currentMaxSpeed = maxPlayerSpeed / (1.0f + 0.08f*mass);
-        if (keys[' '] && (inputDir.x!=0.f || inputDir.z!=0.f)) {
+    // velocidade diminui com massa (agar.io feel) — por célula: menores são mais rápidas
+    float dashMul = 1.0f;
+    if (keys[' '] && (inputDir.x!=0.f || inputDir.z!=0.f)) {
         if (dashCd<=0.f) {
-            currentMaxSpeed *= 12.0f; // Dobra a distância do dash (6.0f * 2)
+            dashMul = 12.0f; // Dobra a distância do dash (6.0f * 2)
             dashCd = 0.6f;
             // Gera partículas brancas no rastro do dash
             for (int i = 0; i < 20; ++i) {
@@ -466,30 +680,47 @@ static void updateGame(float dt)
         }
     }
 
-    Vec3 targetVel = {0.f, 0.f, 0.f};
-    if (inputDir.x != 0.f || inputDir.z != 0.f) {
-        // Se há input, define a velocidade alvo na direção do input
-        targetVel.x = inputDir.x * currentMaxSpeed;
-        targetVel.z = inputDir.z * currentMaxSpeed;
-    }
+    float boostKeep = std::exp(-SPLIT_DECAY*dt);
+    float pull = (cellCount > 1) ? std::min(1.f, MERGE_PULL*dt) : 0.f;
+    for (int i=0; i<cellCount; i++) {
+        Cell& c = cells[i];
+        float currentMaxSpeed = dashMul * maxPlayerSpeed / (1.0f + 0.08f*c.mass);
+
+        Vec3 targetVel = {0.f, 0.f, 0.f};
+        if (inputDir.x != 0.f || inputDir.z != 0.f) {
+            // Se há input, define a velocidade alvo na direção do input
+            targetVel.x = inputDir.x * currentMaxSpeed;
+            targetVel.z = inputDir.z * currentMaxSpeed;
+        }
 
-    // Interpola a velocidade atual em direção à velocidade alvo (aceleração/desaceleração adaptativa)
-    playerCurrentVel.x = playerCurrentVel.x * (1.0f - accelerationFactor) + targetVel.x * accelerationFactor;
-    playerCurrentVel.z = playerCurrentVel.z * (1.0f - accelerationFactor) + targetVel.z * accelerationFactor;
+        // Interpola a velocidade atual em direção à velocidade alvo (aceleração/desaceleração adaptativa)
+        c.vel.x = c.vel.x * (1.0f - accelerationFactor) + targetVel.x * accelerationFactor;
+        c.vel.z = c.vel.z * (1.0f - accelerationFactor) + targetVel.z * accelerationFactor;
 
-    // Aplica desaceleração adicional se não houver input e a velocidade alvo for zero
-    if (inputDir.x == 0.f && inputDir.z == 0.f) {
-        playerCurrentVel.x *= decelerationFactor;
-        playerCurrentVel.z *= decelerationFactor;
-    }
+        // Aplica desaceleração adicional se não houver input e a velocidade alvo for zero
+        if (inputDir.x == 0.f && inputDir.z == 0.f) {
+            c.vel.x *= decelerationFactor;
+            c.vel.z *= decelerationFactor;
+        }
+
+        // Parar completamente se a velocidade for muito baixa para evitar movimento residual
+        if (std::abs(c.vel.x) < 0.1f) c.vel.x = 0.f;
+        if (std::abs(c.vel.z) < 0.1f) c.vel.z = 0.f;
 
-    // Parar completamente se a velocidade for muito baixa para evitar movimento residual
-    if (std::abs(playerCurrentVel.x) < 0.1f) playerCurrentVel.x = 0.f;
-    if (std::abs(playerCurrentVel.z) < 0.1f) playerCurrentVel.z = 0.f;
+        c.pos.x += (c.vel.x + c.boost.x) * dt;
+        c.pos.z += (c.vel.z + c.boost.z) * dt;
+        c.boost.x *= boostKeep; c.boost.z *= boostKeep;
 
-    player.x += playerCurrentVel.x * dt;
-    player.z += playerCurrentVel.z * dt;
-    respawnInside(player);
+        // Recarga vencida: puxa de volta ao centro de massa para recombinar
+        c.mergeCd = std::max(0.f, c.mergeCd - dt);
+        if (c.mergeCd <= 0.f) {
+            c.pos.x += (player.x - c.pos.x) * pull;
+            c.pos.z += (player.z - c.pos.z) * pull;
+        }
+        respawnInside(c.pos);
+    }
+    resolveCells(dt);
+    refreshPlayerTotals();
 
     // Inimigos se movem e rebatem
     for (auto& e : enemies) {
@@ -498,57 +729,71 @@ static void updateGame(float dt)
         if (e.pos.z < -WORLD_HALF || e.pos.z > WORLD_HALF) e.vel.z *= -1.f;
         respawnInside(e.pos);
     }
-    for (auto& p : pellets) p.rot += 60.f*dt;
-
-    // Raio efetivo do jogador (cresce com a massa)
-    float playerRad = playerR * std::cbrt(mass);
-
-    // Comer pellets (crescimento leve)
-    for (auto& p : pellets) {
-        if (dist2(player, p.pos) <= (playerRad + p.r)*(playerRad + p.r)) {
-            score += 1; mass += 0.15f;
-            spawnParticles(p.pos, 5); // Adiciona 5 partículas no local do pellet
-            p.pos = { frand(-WORLD_HALF, WORLD_HALF), 0.5f, frand(-WORLD_HALF, WORLD_HALF) };
-            if (score>0 && score%12==0) nextLevel();
-        }
+    worldTime += dt;
+
+    // Comer pellets (crescimento leve) — só as células sob o raio de cada célula
+    int oldScore = score, eatenTotal = 0;
+    for (int i=0; i<cellCount; i++) {
+        Cell& c = cells[i];
+        Vec3 at;
+        int n = eatPelletsAround(c.pos, c.rad, at);
+        if (n == 0) continue;
+        setCellMass(c, c.mass + 0.15f*(float)n);
+        score += n; eatenTotal += n;
+        spawnParticles(at, 5); // uma rajada por célula por tick, não por pellet
     }
+    // um nível por múltiplo de 12 cruzado neste tick
+    for (int l = oldScore/12; l < score/12; l++) nextLevel();
+    // respawn depois da varredura: o pellet novo não é comido no mesmo tick
+    for (int i=0; i<eatenTotal; i++) spawnPellet();
 
-    // Interação com inimigos (cubo vermelho)
+    // Interação com inimigos (cubo vermelho) — contra todas as células
     for (auto& e : enemies) {
         float er = e.r; // raio do inimigo
-        if (dist2(player, e.pos) <= (playerRad + er)*(playerRad + er)) {
-            if (playerRad > er * 1.04f) {
-                // Jogador come o inimigo MENOR
+        for (int i=0; i<cellCount; i++) {
+            Cell& c = cells[i];
+            if (dist2(c.pos, e.pos) > (c.rad + er)*(c.rad + er)) continue;
+            if (c.rad > er * 1.04f) {
+                // Célula come o inimigo MENOR
                 score += (int)std::round(2 + er*2);
-                mass += 0.25f + 0.35f*er; // cresce proporcional ao tamanho comido
+                setCellMass(c, c.mass + 0.25f + 0.35f*er); // cresce proporcional ao tamanho comido
                 spawnParticles(e.pos, 15);
                 e = makeEnemy();
-                continue;
-            } else if (playerRad < er * 0.96f) {
-                // Inimigo MAIOR → morte instantânea
-                lives = 0; gameOver = true; paused=false; started=true;
                 break;
+            } else if (c.rad < er * 0.96f) {
+                // Inimigo MAIOR → perde a célula; sem células restantes = morte
+                if (cellCount == 1) {
+                    lives = 0; gameOver = true; paused=false; started=true;
+                    break;
+                }
+                spawnParticles(c.pos, 15);
+                cells[i] = cells[--cellCount]; i--;
             } else {
                 // tamanhos parecidos: empurra levemente
-                Vec3 push{ player.x - e.pos.x, 0, player.z - e.pos.z };
+                Vec3 push{ c.pos.x - e.pos.x, 0, c.pos.z - e.pos.z };
                 float len = std::sqrt(push.x*push.x + push.z*push.z) + 1e-5f;
                 push.x/=len; push.z/=len;
-                player.x += push.x * 0.6f; player.z += push.z * 0.6f;
-                respawnInside(player);
+                c.pos.x += push.x * 0.6f; c.pos.z += push.z * 0.6f;
+                respawnInside(c.pos);
             }
         }
+        if (gameOver) break;
     }
+    refreshPlayerTotals();
 
     // Atualiza partículas
-    for (auto it = particles.begin(); it != particles.end(); ) {
-        it->pos.x += it->vel.x * dt;
-        it->pos.y += it->vel.y * dt;
-        it->pos.z += it->vel.z * dt;
-        it->life -= dt; // Partículas desaparecem com o tempo
-        if (it->life <= 0.f) {
-            it = particles.erase(it);
+    for (size_t i = 0; i < particles.size(); ) {
+        Particle& p = particles[i];
+        p.pos.x += p.vel.x * dt;
+        p.pos.y += p.vel.y * dt;
+        p.pos.z += p.vel.z * dt;
+        p.life -= dt; // Partículas desaparecem com o tempo
+        if (p.life <= 0.f) {
+            // troca com a última e remove (O(1); a ordem não importa)
+            p = particles.back();
+            particles.pop_back();
         } else {
-            ++it;
+            ++i;
         }
     }
 }
@@ -571,13 +816,14 @@ static void display()
     glMatrixMode(GL_MODELVIEW); glLoadIdentity();
     Vec3 eye{ player.x, 18.0f, player.z + 16.0f };
     gluLookAt(eye.x, eye.y, eye.z, player.x, player.y, player.z, 0.0, 1.0, 0.0);
+    computeViewRect(eye, player, 60.f, winW/(float)winH, 600.f);
     setLight();
 
     // Desenha o cenário
     drawArena();
 
     // Desenha entidades do jogo
-    for (const auto& p : pellets) drawPellet(p);
+    drawPellets();
     for (const auto& e : enemies) drawEnemy(e);
     drawPlayer();
     drawParticles(); // Desenha as partículas
@@ -628,6 +874,12 @@ static void keyDown(unsigned char k, int, int)
     if (k=='p' || k=='P') { if (!gameOver) paused = !paused; }
     if (k=='r' || k=='R') { resetGame(); }
     if (k=='m' || k=='M') { mouseFollow = !mouseFollow; }
+    if ((k=='e' || k=='E') && !menuActive && !paused && !gameOver) {
+        // divide na direção para onde o jogador está virado (mesma convenção do playerYaw)
+        float yaw = playerYaw * 3.1415926f / 180.f;
+        splitCells(std::sin(yaw), -std::cos(yaw));
+        refreshPlayerTotals();
+    }
 }
 
 static void keyUp(unsigned char k, int, int) { keys[(unsigned char)std::tolower(k)] = false; }